@@ -5,6 +5,7 @@
 #include <EEPROM.h>
 #include <ESPmDNS.h>
 #include <Update.h>
+#include <esp_system.h>
 
 
 #define PWM_PIN     25       // Definicja pinu GPIO, do którego podłączona jest dioda LED
@@ -15,6 +16,47 @@
 #define STATE_CONNECTING_TO_WIFI        1
 #define STATE_RUNNING                   2
 
+// Ustawienia bufora zdarzeń (trace)
+#ifndef TRACE_SERIAL
+#define TRACE_SERIAL                    1           // Czy wypisywać zdarzenia do UART (0 - tylko bufor)
+#endif
+#define TRACE_CAPACITY                  256         // Liczba zdarzeń w buforze (musi być potęgą dwójki)
+#define TRACE_MAGIC                     0x54524331  // Znacznik poprawnej zawartości bufora w pamięci RTC ("TRC1")
+#define TRACE_HEAP_STEP                 512         // Minimalny spadek najniższego stanu sterty zapisywany jako zdarzenie
+#define TRACE_SERIAL_LINE               128         // Wolne miejsce w buforze UART wymagane do wypisania jednego zdarzenia
+
+// Definicje typów zdarzeń
+#define TRACE_BOOT                      0   // Start programu (param - numer uruchomienia, value - przyczyna resetu)
+#define TRACE_BUTTON                    1   // Zbocze przycisku (value - 1 wciśnięty, 0 puszczony)
+#define TRACE_LED                       2   // Przełączenie diody LED (value - 1 włączona, 0 wyłączona)
+#define TRACE_BRIGHTNESS                3   // Zmiana jasności (param - liczba połączonych kolejnych zmian, value - nowa jasność)
+#define TRACE_WIFI_STATUS               4   // Zmiana statusu WiFi (value - wl_status_t)
+#define TRACE_WIFI_CONNECTED            5   // Połączono z siecią WiFi (value - adres IP)
+#define TRACE_WIFI_LOST                 6   // Utracono połączenie z siecią WiFi
+#define TRACE_WIFI_AP_START             7   // Uruchomiono punkt dostępowy "LED setup"
+#define TRACE_MDNS                      8   // Wynik inicjalizacji mDNS (value - 1 sukces, 0 błąd)
+#define TRACE_HTTP_REQUEST              9   // Zapytanie HTTP (param - numer ścieżki, value - metoda HTTP)
+#define TRACE_OTA_START                 10  // Rozpoczęcie aktualizacji oprogramowania
+#define TRACE_OTA_END                   11  // Zakończenie aktualizacji (value - liczba bajtów)
+#define TRACE_OTA_ERROR                 12  // Błąd aktualizacji (value - kod błędu biblioteki Update)
+#define TRACE_HEAP_LOW                  13  // Nowy najniższy stan wolnej sterty (value - liczba bajtów)
+#define TRACE_RESTART                   14  // Programowy restart modułu (param - powód restartu)
+
+// Definicje ścieżek serwera HTTP zapisywanych w zdarzeniach
+#define TRACE_ROUTE_ROOT                0
+#define TRACE_ROUTE_SAVE                1
+#define TRACE_ROUTE_UPLOAD              2
+#define TRACE_ROUTE_NETWORKS            3
+#define TRACE_ROUTE_SET_BRIGHTNESS      4
+#define TRACE_ROUTE_TOGGLE_LED          5
+#define TRACE_ROUTE_SAVE_NETWORK        6
+#define TRACE_ROUTE_TRACE               7
+
+// Definicje powodów programowego restartu
+#define TRACE_RESTART_SETTINGS          0
+#define TRACE_RESTART_NETWORK           1
+#define TRACE_RESTART_FIRMWARE          2
+
 // Struktura danych do przechowywania ustawień
 struct Settings {
     char ledName[32] = "";      // Nazwa urządzenia
@@ -40,6 +82,223 @@ unsigned long debounceDelay = 50;   // Opóźnienie anty-drganiowe przycisku
 bool lastButtonState = LOW;         // Stan przycisku z poprzedniego odczytu
 bool buttonPressed = false;         // Flaga informująca o wciśnięciu przycisku
 
+// Struktura pojedynczego zdarzenia w buforze (12 bajtów)
+struct TraceEvent {
+    uint32_t time;              // Czas zdarzenia (millis)
+    uint16_t type;              // Typ zdarzenia (TRACE_*)
+    uint16_t param;             // Dodatkowy parametr zależny od typu zdarzenia
+    uint32_t value;             // Wartość zależna od typu zdarzenia
+};
+static_assert(sizeof(TraceEvent) == 12, "TraceEvent layout is part of the /api/trace format");
+
+// Nagłówek bufora zdarzeń, wysyłany również jako początek odpowiedzi /api/trace
+struct TraceHeader {
+    uint32_t magic;             // Znacznik poprawnej zawartości (TRACE_MAGIC)
+    uint16_t capacity;          // Pojemność bufora (TRACE_CAPACITY)
+    uint16_t eventSize;         // Rozmiar pojedynczego zdarzenia w bajtach
+    uint32_t head;              // Łączna liczba zapisanych zdarzeń (indeks następnego zapisu)
+    uint32_t boots;             // Liczba uruchomień od wyczyszczenia bufora
+};
+static_assert(sizeof(TraceHeader) == 16, "TraceHeader layout is part of the /api/trace format");
+
+// Bufor zdarzeń w pamięci RTC, która nie jest czyszczona przy programowym resecie
+struct TraceBuffer {
+    TraceHeader header;
+    TraceEvent events[TRACE_CAPACITY];
+};
+
+RTC_NOINIT_ATTR TraceBuffer traceBuffer;    // Bufor zdarzeń zachowywany pomiędzy programowymi resetami
+uint32_t traceHeapLowWater = UINT32_MAX;    // Najniższy zapisany stan wolnej sterty
+wl_status_t traceWiFiStatus = WL_NO_SHIELD; // Ostatni zapisany status WiFi
+uint32_t traceSerialTail = 0;               // Indeks następnego zdarzenia do wypisania do UART
+bool uploadStarted = false;                 // Flaga informująca o rozpoczęciu przesyłania pliku na /upload
+
+// Nazwy ścieżek HTTP używane przy wypisywaniu zdarzeń do UART
+const char* traceRouteNames[] = {
+    "/", "/save", "/upload", "/networks", "/setBrightness", "/toggleLED", "/save_network", "/api/trace"
+};
+
+
+// Funkcja wypisująca pojedyncze zdarzenie do UART
+// Używa wyłącznie Serial.printf, dzięki czemu nie tworzy obiektów String
+void tracePrint(const TraceEvent& event) {
+    Serial.printf("[%10lu] ", (unsigned long)event.time);
+    switch (event.type) {
+        case TRACE_BOOT:
+            Serial.printf("Boot #%u, reset reason: %lu\n", event.param, (unsigned long)event.value);
+            break;
+        case TRACE_BUTTON:
+            Serial.println(event.value ? "Button pressed!" : "Button released");
+            break;
+        case TRACE_LED:
+            Serial.println(event.value ? "LED turned on" : "LED turned off");
+            break;
+        case TRACE_BRIGHTNESS:
+            Serial.printf("Brightness: %lu (%u changes)\n", (unsigned long)event.value, event.param);
+            break;
+        case TRACE_WIFI_STATUS:
+            Serial.printf("WiFi status: %lu\n", (unsigned long)event.value);
+            break;
+        case TRACE_WIFI_CONNECTED:
+            Serial.printf("Connected to WiFi, IP: %lu.%lu.%lu.%lu\n",
+                (unsigned long)(event.value & 0xFF), (unsigned long)((event.value >> 8) & 0xFF),
+                (unsigned long)((event.value >> 16) & 0xFF), (unsigned long)(event.value >> 24));
+            break;
+        case TRACE_WIFI_LOST:
+            Serial.println("WiFi connection lost...");
+            break;
+        case TRACE_WIFI_AP_START:
+            Serial.println("Unable to connect. Serving \"LED Light setup\" WiFi for configuration, while still trying to connect...");
+            break;
+        case TRACE_MDNS:
+            Serial.println(event.value ? "mDNS responder started" : "Error setting up mDNS responder!");
+            break;
+        case TRACE_HTTP_REQUEST:
+            Serial.printf("HTTP %lu %s\n", (unsigned long)event.value,
+                event.param < sizeof(traceRouteNames) / sizeof(traceRouteNames[0]) ? traceRouteNames[event.param] : "?");
+            break;
+        case TRACE_OTA_START:
+            Serial.println("Updating Firmware...");
+            break;
+        case TRACE_OTA_END:
+            Serial.printf("Update Success: %lu bytes\n", (unsigned long)event.value);
+            break;
+        case TRACE_OTA_ERROR:
+            Serial.printf("Update error: %lu\n", (unsigned long)event.value);
+            break;
+        case TRACE_HEAP_LOW:
+            Serial.printf("Heap low-water mark: %lu bytes\n", (unsigned long)event.value);
+            break;
+        case TRACE_RESTART:
+            Serial.printf("Restarting... (reason %u)\n", event.param);
+            break;
+        default:
+            Serial.printf("Unknown event %u: %u %lu\n", event.type, event.param, (unsigned long)event.value);
+            break;
+    }
+}
+
+// Funkcja zapisująca zdarzenie do bufora
+// Jedynym producentem jest pętla loop() (również obsługa HTTP), więc zapis nie wymaga blokad -
+// indeks jest publikowany dopiero po zapisaniu całego zdarzenia
+void traceEvent(uint16_t type, uint16_t param = 0, uint32_t value = 0) {
+    uint32_t head = traceBuffer.header.head;
+    TraceEvent& event = traceBuffer.events[head & (TRACE_CAPACITY - 1)];
+    event.time = millis();
+    event.type = type;
+    event.param = param;
+    event.value = value;
+    __atomic_store_n(&traceBuffer.header.head, head + 1, __ATOMIC_RELEASE);
+}
+
+// Funkcja zapisująca zmianę jasności do bufora
+// Kolejne zmiany (np. przeciąganie suwaka) są łączone w jedno zdarzenie, aby nie wypierały z bufora wcześniejszej historii
+void traceBrightness(uint8_t brightness) {
+    uint32_t head = traceBuffer.header.head;
+    TraceEvent& last = traceBuffer.events[(head - 1) & (TRACE_CAPACITY - 1)];
+    if (head == 0 || last.type != TRACE_BRIGHTNESS || last.param == UINT16_MAX) {
+        traceEvent(TRACE_BRIGHTNESS, 1, brightness);
+        return;
+    }
+    last.time = millis();
+    last.param++;
+    last.value = brightness;
+    if (traceSerialTail == head) {      // Ponowne wypisanie zdarzenia do UART, jeśli zostało już wypisane
+        traceSerialTail = head - 1;
+    }
+}
+
+// Funkcja wypisująca do UART zdarzenia, które jeszcze nie zostały wypisane
+// Wywoływana w loop() i wypisująca tylko tyle, ile zmieści się w buforze UART, dzięki czemu nie blokuje programu
+void traceSerialFlush() {
+#if TRACE_SERIAL
+    uint32_t head = traceBuffer.header.head;
+    if (head - traceSerialTail > TRACE_CAPACITY) {  // Pominięcie zdarzeń nadpisanych przed wypisaniem
+        Serial.printf("%lu trace events dropped\n", (unsigned long)(head - traceSerialTail - TRACE_CAPACITY));
+        traceSerialTail = head - TRACE_CAPACITY;
+    }
+    while (traceSerialTail != head && Serial.availableForWrite() >= TRACE_SERIAL_LINE) {
+        tracePrint(traceBuffer.events[traceSerialTail & (TRACE_CAPACITY - 1)]);
+        traceSerialTail++;
+    }
+#endif
+}
+
+// Funkcja inicjalizująca bufor zdarzeń
+// Zawartość bufora jest zachowywana po programowym resecie, a czyszczona po włączeniu zasilania lub gdy jest niepoprawna
+void traceBegin() {
+    esp_reset_reason_t reason = esp_reset_reason();
+    if (reason == ESP_RST_POWERON ||
+        traceBuffer.header.magic != TRACE_MAGIC ||
+        traceBuffer.header.capacity != TRACE_CAPACITY ||
+        traceBuffer.header.eventSize != sizeof(TraceEvent)) {
+        memset(&traceBuffer, 0, sizeof(traceBuffer));
+        traceBuffer.header.magic = TRACE_MAGIC;
+        traceBuffer.header.capacity = TRACE_CAPACITY;
+        traceBuffer.header.eventSize = sizeof(TraceEvent);
+    }
+#if TRACE_SERIAL
+    else {
+        // Wypisanie zdarzeń sprzed resetu do UART
+        uint32_t head = traceBuffer.header.head;
+        uint32_t count = head < TRACE_CAPACITY ? head : TRACE_CAPACITY;
+        Serial.println("Trace before reset:");
+        for (uint32_t i = head - count; i != head; i++) {
+            tracePrint(traceBuffer.events[i & (TRACE_CAPACITY - 1)]);
+        }
+        Serial.println("------------------------");
+    }
+#endif
+    traceSerialTail = traceBuffer.header.head;
+    traceBuffer.header.boots++;
+    traceEvent(TRACE_BOOT, (uint16_t)traceBuffer.header.boots, reason);
+}
+
+// Funkcja zapisująca zmiany statusu WiFi oraz nowe najniższe stany wolnej sterty
+void traceMonitor() {
+    wl_status_t status = WiFi.status();
+    if (status != traceWiFiStatus) {
+        traceWiFiStatus = status;
+        traceEvent(TRACE_WIFI_STATUS, 0, status);
+    }
+    uint32_t minHeap = ESP.getMinFreeHeap();
+    if (minHeap + TRACE_HEAP_STEP <= traceHeapLowWater) {
+        traceHeapLowWater = minHeap;
+        traceEvent(TRACE_HEAP_LOW, 0, minHeap);
+    }
+}
+
+// Funkcja zapisująca zdarzenie restartu i restartująca moduł ESP
+void traceRestart(uint16_t reason) {
+    traceEvent(TRACE_RESTART, reason);
+    ESP.restart();
+}
+
+// Funkcja zwracająca obsługę ścieżki HTTP, która przed wywołaniem zapisuje zdarzenie zapytania
+WebServer::THandlerFunction traced(uint16_t route, WebServer::THandlerFunction handler) {
+    return [route, handler]() {
+        traceEvent(TRACE_HTTP_REQUEST, route, server.method());
+        handler();
+    };
+}
+
+// Funkcja obsługująca eksport bufora zdarzeń
+// Wysyła nagłówek i zdarzenia w kolejności chronologicznej bezpośrednio z pamięci RTC, bez kopiowania bufora
+void handleTrace() {
+    uint32_t head = traceBuffer.header.head;
+    uint32_t count = head < TRACE_CAPACITY ? head : TRACE_CAPACITY;
+    uint32_t start = (head - count) & (TRACE_CAPACITY - 1);
+    uint32_t firstPart = count < TRACE_CAPACITY - start ? count : TRACE_CAPACITY - start;
+
+    server.setContentLength(sizeof(TraceHeader) + count * sizeof(TraceEvent));
+    server.send(200, "application/octet-stream", "");
+    server.sendContent((const char*)&traceBuffer.header, sizeof(TraceHeader));
+    server.sendContent((const char*)&traceBuffer.events[start], firstPart * sizeof(TraceEvent));
+    if (count > firstPart) {
+        server.sendContent((const char*)&traceBuffer.events[0], (count - firstPart) * sizeof(TraceEvent));
+    }
+}
+
 
 // Funkcja zwracająca nagłówek HTML
 // Funkcja przyjmuje jeden argument typu bool, który określa, czy strona ma być przekierowana do strony głównej
@@ -326,6 +585,7 @@ void handleSetBrightness() {
     if (settings.ledEnabled) {                              // Sprawdzenie, czy dioda ma być włączona
       ledcWrite(ledChannel, settings.ledBrightness);        // Ustawienie jasności diody LED
     }
+    traceBrightness(settings.ledBrightness);                 // Zapisanie zdarzenia zmiany jasności
     server.send(200, "text/plain", "OK"); // Wysłanie odpowiedzi do klienta
   } else {
     server.send(400, "text/plain", "Missing value"); // Wysłanie odpowiedzi o błędzie do klienta
@@ -393,11 +653,11 @@ void handleNetworks() {
 // Funkcja obsługująca przełączanie diody LED
 void handleToggleLED() {
   if (settings.ledEnabled) {                        // Sprawdzenie, czy dioda jest włączona
-    Serial.println("LED turned off");               // Wypisanie informacji o wyłączeniu diody LED do UART
+    traceEvent(TRACE_LED, 0, 0);                    // Zapisanie zdarzenia wyłączenia diody LED
     settings.ledEnabled = false;                    // Ustawienie zmiennej informującej o stanie diody LED na wyłączony
     ledcWrite(ledChannel, 0);                       // Wyłączenie diody LED
   } else {                                          // W przypadku gdy dioda jest wyłączona
-    Serial.println("LED turned on");                // Wypisanie informacji o włączeniu diody LED do UART
+    traceEvent(TRACE_LED, 0, 1);                    // Zapisanie zdarzenia włączenia diody LED
     ledcWrite(ledChannel, settings.ledBrightness);  // Włączenie diody LED
     settings.ledEnabled = true;                     // Ustawienie zmiennej informującej o stanie diody LED na włączony
   }
@@ -429,6 +689,7 @@ void handleSave() {
             val.toCharArray(settings.ledName, (uint8_t)32); // Skopiuj wartość parametru do zmiennej przechowującej nazwę urządzenia
         } else if (var == "ledBright") {            // Jeśli nazwa parametru to "ledBright"
             settings.ledBrightness = val.toInt();   // Skonwertuj wartość parametru na liczbę i przypisz do zmiennej jasności diody LED
+            traceBrightness(settings.ledBrightness); // Zapisz zdarzenie zmiany jasności
         } else if (var == "ssid") {                 // Jeśli nazwa parametru to "ssid"
             ssid = String(val);                     // Przypisz wartość parametru do zmiennej przechowującej nazwę sieci WiFi
         } else if (var == "pwd") {                  // Jeśli nazwa parametru to "pwd"
@@ -486,7 +747,7 @@ void handleSave() {
         }
 
         delay(100);                 // Opóźnienie w celu zmiany trybu pracy modułu WiFi
-        ESP.restart();              // Restart modułu ESP
+        traceRestart(TRACE_RESTART_SETTINGS); // Restart modułu ESP
     }
 }
 
@@ -494,27 +755,34 @@ void handleSave() {
 void handleFirmwareUpload() {
     HTTPUpload& upload = server.upload();                                           // Przypisanie przesłanych danych do zmiennej upload
     if (upload.status == UPLOAD_FILE_START) {                                       // Jeśli rozpoczęto przesyłanie pliku
-        Serial.printf("Updating Firmware: %s\n", upload.filename.c_str());          // Wypisanie informacji o rozpoczęciu aktualizacji oprogramowania do UART
+        uploadStarted = true;                                                       // Ustawienie flagi rozpoczęcia przesyłania pliku
+        traceEvent(TRACE_HTTP_REQUEST, TRACE_ROUTE_UPLOAD, server.method());        // Zapisanie zdarzenia zapytania przed fazami aktualizacji
+        traceEvent(TRACE_OTA_START);                                                // Zapisanie zdarzenia rozpoczęcia aktualizacji oprogramowania
         if (!Update.begin(UPDATE_SIZE_UNKNOWN)) {                                   // Rozpoczęcie aktualizacji oprogramowania i sprawdzenie czy funkcja zwróciła błąd
-            Update.printError(Serial);                                              // Wypisanie informacji o błędzie aktualizacji do UART
+            traceEvent(TRACE_OTA_ERROR, 0, Update.getError());                      // Zapisanie zdarzenia błędu aktualizacji
         }
+    } else if (Update.hasError()) {                                                 // Jeśli aktualizacja już zakończyła się błędem
+        return;                                                                     // Pominięcie pozostałych danych, błąd został już zapisany
     } else if (upload.status == UPLOAD_FILE_WRITE) {                                // Jeśli przesyłany plik jest zapisywany
         if (Update.write(upload.buf, upload.currentSize) != upload.currentSize) {   // Zapisanie przesyłanych danych i sprawdzenie czy zapisano tyle danych ile przesłano
-            Update.printError(Serial);                                              // Wypisanie informacji o błędzie aktualizacji do UART
+            traceEvent(TRACE_OTA_ERROR, 0, Update.getError());                      // Zapisanie zdarzenia błędu aktualizacji
         }
     } else if (upload.status == UPLOAD_FILE_END) {                                  // Jeśli przesyłanie pliku zakończono
         if (Update.end(true)) {                                                     // Zakończenie aktualizacji oprogramowania i sprawdzenie czy zakończono poprawnie
-            Serial.printf("Update Success: %u bytes\n", upload.totalSize);          // Wypisanie informacji o zakończeniu aktualizacji do UART
+            traceEvent(TRACE_OTA_END, 0, upload.totalSize);                         // Zapisanie zdarzenia zakończenia aktualizacji
         } else {                                                                    // Jeśli aktualizacja zakończyła się błędem
-            Update.printError(Serial);                                              // Wypisanie informacji o błędzie aktualizacji do UART
+            traceEvent(TRACE_OTA_ERROR, 0, Update.getError());                      // Zapisanie zdarzenia błędu aktualizacji
         }
     }
 }
 
 // Funkcja obsługująca aktualizację oprogramowania
 void handleFirmwareUpdate() {
+    if (!uploadStarted) {                   // Jeśli zapytanie nie zawierało pliku, zdarzenie zapytania nie zostało jeszcze zapisane
+        traceEvent(TRACE_HTTP_REQUEST, TRACE_ROUTE_UPLOAD, server.method());
+    }
+    uploadStarted = false;                  // Wyczyszczenie flagi przed kolejnym zapytaniem
     if (!Update.hasError()) {               // Sprawdzenie, czy aktualizacja oprogramowania nie zakończyła się błędem
-        Serial.println("Restarting...");    // Wypisanie informacji o restarcie do UART
         // Wysłanie odpowiedzi do klienta
         server.send(200, "text/html", "<!DOCTYPE html><html>" + 
             htmlHead(true) + 
@@ -524,7 +792,7 @@ void handleFirmwareUpdate() {
                 "<p>Redirecting to main page...</p>"
             "</div></body></html>");
         delay(100);                         // Opóźnienie w celu zapisania danych i wysłania odpowiedzi do klienta
-        ESP.restart();                      // Restart modułu ESP
+        traceRestart(TRACE_RESTART_FIRMWARE); // Restart modułu ESP
     } else {                                // Jeśli aktualizacja oprogramowania zakończyła się błędem
         // Wysłanie odpowiedzi do klienta
         server.send(500, "text/html", "<!DOCTYPE html><html>" + 
@@ -545,10 +813,11 @@ void handleButton() {
     if ((millis() - lastDebounceTime) > debounceDelay) { // Sprawdzenie, czy upłynął czas od ostatniej zmiany stanu przycisku
         if (buttonState == LOW && !buttonPressed) {      // Sprawdzenie, czy przycisk jest wciśnięty i czy nie był wcześniej wciśnięty
             buttonPressed = true;                        // Ustawienie zmiennej informującej o wciśnięciu przycisku na true
-            Serial.println("Button pressed!");           // Wypisanie informacji o wciśnięciu przycisku do UART
+            traceEvent(TRACE_BUTTON, 0, 1);              // Zapisanie zdarzenia wciśnięcia przycisku
             handleToggleLED();                           // Wywołanie funkcji obsługującej przełączanie diody LED
-        } else if (buttonState == HIGH) {                // Jeśli przycisk nie jest wciśnięty
+        } else if (buttonState == HIGH && buttonPressed) { // Jeśli przycisk został puszczony
             buttonPressed = false;                       // Ustawienie zmiennej informującej o wciśnięciu przycisku na false
+            traceEvent(TRACE_BUTTON, 0, 0);              // Zapisanie zdarzenia puszczenia przycisku
         }
     }
   lastButtonState = buttonState;                // Zapisanie stanu przycisku
@@ -561,6 +830,8 @@ void setup() {
   Serial.println("########################");
   Serial.println("Serial started");
 
+  traceBegin();                                     // Inicjalizacja bufora zdarzeń
+
   EEPROM.begin(sizeof(settings));                   // Inicjalizacja pamięci EEPROM
   EEPROM.get(0, settings);                          // Odczytanie ustawień z pamięci EEPROM
 
@@ -585,29 +856,25 @@ void setup() {
   WiFi.setAutoReconnect(true);          // Włączenie automatycznego ponownego łączenia z siecią WiFi
   WiFi.begin();                         // Rozpoczęcie łączenia z siecią WiFi
 
-  if (!MDNS.begin(settings.ledName)) {                  // Inicjalizacja mDNS i sprawdzenie czy wystąpił błąd
-    Serial.println("Error setting up mDNS responder!"); // Wypisanie informacji o błędzie do UART
-  } else {                                              // Jeśli inicjalizacja mDNS zakończyła się sukcesem
-    Serial.println("mDNS responder started");           // Wypisanie informacji o sukcesie do UART
-  }
-
-  wifi_config_t conf;                       // Zmienna przechowująca konfigurację WiFi
-  esp_wifi_get_config(WIFI_IF_STA, &conf);  // Pobranie konfiguracji WiFi
+  traceEvent(TRACE_MDNS, 0, MDNS.begin(settings.ledName)); // Inicjalizacja mDNS i zapisanie zdarzenia z jej wynikiem
 
+#if TRACE_SERIAL
   // Wypisanie informacji o konfiguracji WiFi do UART
   Serial.println("------------------------");
   Serial.println("Connecting to WiFi...");
   Serial.println("Network name (SSID): " + getSSID());
+#endif
 
 
   // Zgłoszenie do serwera HTTP obsługi różnych ścieżek
-  server.on("/", handleRoot);
-  server.on("/save", handleSave);
-  server.on("/upload", HTTP_POST, handleFirmwareUpdate, handleFirmwareUpload);
-  server.on("/networks", handleNetworks);
-  server.on("/setBrightness", handleSetBrightness);
-  server.on("/toggleLED", handleToggleLED);
-  server.on("/save_network", HTTP_POST, [](){
+  server.on("/", traced(TRACE_ROUTE_ROOT, handleRoot));
+  server.on("/save", traced(TRACE_ROUTE_SAVE, handleSave));
+  server.on("/upload", HTTP_POST, handleFirmwareUpdate, handleFirmwareUpload); // Zdarzenie zapytania zapisuje handleFirmwareUpload
+  server.on("/networks", traced(TRACE_ROUTE_NETWORKS, handleNetworks));
+  server.on("/setBrightness", handleSetBrightness); // Zapytanie jest zapisywane jako zdarzenie zmiany jasności
+  server.on("/toggleLED", traced(TRACE_ROUTE_TOGGLE_LED, handleToggleLED));
+  server.on("/api/trace", traced(TRACE_ROUTE_TRACE, handleTrace));
+  server.on("/save_network", HTTP_POST, traced(TRACE_ROUTE_SAVE_NETWORK, [](){
         if (server.hasArg("ssid") && server.hasArg("password")) { // Sprawdzenie, czy przesłano nazwę sieci WiFi i hasło
             // Zapis przesłanych danych do zmiennych
             String ssid = String(server.arg("ssid"));
@@ -632,11 +899,11 @@ void setup() {
             }
 
             delay(100);     // Opóźnienie w celu zmiany trybu pracy modułu WiFi i zapisania danych
-            ESP.restart();  // Restart modułu ESP
+            traceRestart(TRACE_RESTART_NETWORK); // Restart modułu ESP
         } else {            // Jeśli nie przesłano nazwy sieci WiFi i hasła
             server.send(200, "text/html", "Wrong parameters"); // Wysłanie odpowiedzi o błędzie do klienta
         }
-    });
+    }));
 
   server.begin(); // Start serwera HTTP
   
@@ -656,9 +923,13 @@ void setup() {
 // Główna pętla programu wykonywana w nieskończoność
 void loop() {
   handleButton();                           // Obsługa przycisku
+  traceMonitor();                           // Zapisanie zmian statusu WiFi i stanu sterty do bufora zdarzeń
+  traceSerialFlush();                       // Wypisanie nowych zdarzeń do UART
   if (state == STATE_CONNECTING_TO_WIFI) {  // Jeśli stan to łączenie z siecią WiFi
     if (WiFi.status() == WL_CONNECTED) {    // Jeśli połączono z siecią WiFi
       WiFi.mode(WIFI_STA);                  // Ustawienie trybu pracy modułu WiFi na STATION
+      traceEvent(TRACE_WIFI_CONNECTED, 0, (uint32_t)WiFi.localIP()); // Zapisanie zdarzenia połączenia z siecią WiFi
+#if TRACE_SERIAL
       // Wypisanie informacji o połączeniu z siecią WiFi do UART
       Serial.println("------------------------");
       Serial.println("Connected to WiFi:   " + getSSID());
@@ -666,23 +937,23 @@ void loop() {
       Serial.println("mDNS address:        http://" + String(settings.ledName) + ".local");
       Serial.println("Subnet Mask:         " + WiFi.subnetMask().toString());
       Serial.println("Gateway IP:          " + WiFi.gatewayIP().toString());
+#endif
 
       firstRun = true;                      // Ustawienie flagi pierwszego uruchomienia na true
       state = STATE_RUNNING;                // Ustawienie stanu na działanie
     } else if (firstRun) {                  // Jeśli flaga pierwszego uruchomienia jest ustawiona na true
       firstRun = false;                     // Ustawienie flagi pierwszego uruchomienia na false
-      // Wypisanie informacji o nieudanym połączeniu z siecią WiFi do UART
-      Serial.println("Unable to connect. Serving \"LED Light setup\" WiFi for configuration, while still trying to connect...");
+      traceEvent(TRACE_WIFI_AP_START);      // Zapisanie zdarzenia uruchomienia punktu dostępowego
+#if TRACE_SERIAL
       Serial.println("IP for that device in \"LED Light setup\" WiFi network is 192.168.4.1 or mDNS address http://" + String(settings.ledName) + ".local");
+#endif
       WiFi.softAP("LED setup");             // Uruchomienie punktu dostępowego WiFi
       WiFi.mode(WIFI_AP_STA);               // Ustawienie trybu pracy modułu WiFi na AP+STA
     }
   }
 
   if (WiFi.status() != WL_CONNECTED && state != STATE_CONNECTING_TO_WIFI) { // Jeśli połączenie zostało utracone i stan nie jest łączenie z siecią WiFi
-    // Wypisanie informacji o utraceniu połączenia z siecią WiFi do UART
-    Serial.println("------------------------");
-    Serial.println("WiFi connection lost...");
+    traceEvent(TRACE_WIFI_LOST);            // Zapisanie zdarzenia utraty połączenia z siecią WiFi
     firstRun = true;                        // Ustawienie flagi pierwszego uruchomienia na true
     state = STATE_CONNECTING_TO_WIFI;       // Ustawienie stanu na łączenie z siecią WiFi
   }
@@ -0,0 +1,541 @@
+
+// Generator obciążenia dla interfejsu HTTP sterownika LED (urządzenia lub serwera zastępczego standin.cpp)
+// Odtwarza profile ruchu: serie zapytań /setBrightness z suwaka, równoczesne ładowanie /, /networks oraz aktualizacje
+// w trakcie sterowania, a na koniec wypisuje przepustowość, opóźnienia p50/p99/p999 i odsetek błędów dla każdej ścieżki
+//
+// Strumienie o zadanej częstotliwości i nagrany ruch są wysyłane według harmonogramu, a opóźnienie liczone jest
+// od zaplanowanego czasu wysłania, więc zator po stronie serwera nie zaniża wyników (brak "coordinated omission").
+// Strumienie w pętli zamkniętej (/, /networks, /upload) mierzą opóźnienie od faktycznego wysłania zapytania
+
+#include <arpa/inet.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cctype>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+typedef std::chrono::steady_clock Clock;
+
+
+// Ustawienia generatora obciążenia
+struct Options {
+    std::string host = "127.0.0.1";     // Adres urządzenia lub serwera zastępczego
+    int port = 8080;                    // Port serwera HTTP
+    std::string profile = "mixed";      // Nazwa wbudowanego profilu ruchu
+    std::string replayFile;             // Plik z nagranym ruchem do odtworzenia
+    double duration = 20;               // Czas trwania testu w sekundach
+    double scale = 1;                   // Mnożnik liczby klientów i częstotliwości zapytań
+    int timeoutMs = 10000;              // Czas oczekiwania na odpowiedź
+    std::string jsonFile;               // Plik z podsumowaniem w formacie JSON
+    std::string firmwareFile;           // Obraz oprogramowania wysyłany zamiast wypełnienia przy POST /upload
+};
+
+#define MAX_BODY_BYTES  (16 * 1024 * 1024)  // Największy dopuszczalny rozmiar treści w nagranym ruchu
+#define CONNECT_FAILED  -1                  // Kod wyniku zapytania, dla którego nie udało się nawiązać połączenia
+#define RETRY_DELAY_MS  500                 // Przerwa po nieudanym połączeniu w strumieniach w pętli zamkniętej
+
+// Strumień zapytań o jednej ścieżce
+// Przy rate > 0 zapytania są wysyłane według harmonogramu (seriami burstMs/pauseMs), przy rate == 0 każde połączenie
+// wysyła kolejne zapytanie zaraz po otrzymaniu odpowiedzi na poprzednie
+struct Stream {
+    std::string method;                 // Metoda HTTP
+    std::string path;                   // Ścieżka, "%d" jest zastępowane kolejną wartością suwaka
+    size_t bodyBytes;                   // Rozmiar przesyłanego pliku (tylko dla POST /upload)
+    int connections;                    // Liczba równoległych połączeń
+    double rate;                        // Łączna liczba zapytań na sekundę w trakcie serii (0 - pętla zamknięta)
+    int burstMs;                        // Czas trwania serii (0 - ruch ciągły)
+    int pauseMs;                        // Przerwa pomiędzy seriami
+};
+
+// Zapytanie z nagranego ruchu
+struct ReplayEntry {
+    double timeMs;                      // Czas wysłania względem początku nagrania
+    std::string method;                 // Metoda HTTP
+    std::string path;                   // Ścieżka wraz z parametrami
+    size_t bodyBytes;                   // Rozmiar przesyłanego pliku (tylko dla POST /upload)
+};
+
+// Wyniki zapytań jednej ścieżki
+struct RouteStats {
+    std::vector<double> latencies;      // Opóźnienia zakończonych poprawnie zapytań w milisekundach
+    uint64_t requests = 0;              // Liczba wysłanych zapytań
+    uint64_t errors = 0;                // Liczba zapytań zakończonych błędem połączenia lub kodem innym niż 2xx
+    uint64_t connectErrors = 0;         // Liczba zapytań, dla których nie udało się nawiązać połączenia (zawarta w errors)
+    uint64_t bytes = 0;                 // Liczba odebranych bajtów
+};
+
+Options options;                        // Zmienna przechowująca ustawienia
+sockaddr_in target;                     // Adres serwera
+std::mutex statsMutex;                  // Blokada chroniąca mapę wyników
+std::map<std::string, RouteStats> stats; // Wyniki zapytań dla poszczególnych ścieżek
+std::string firmware;                   // Zawartość pliku --firmware
+
+
+// Funkcja zwracająca ścieżkę bez parametrów zapytania, używaną jako klucz wyników
+std::string routeOf(const std::string& path) {
+    return path.substr(0, path.find('?'));
+}
+
+// Funkcja budująca zapytanie HTTP, dla POST /upload w postaci multipart/form-data jak formularz aktualizacji
+// Przesyłany jest obraz z --firmware, a bez niego bodyBytes bajtów wypełnienia 0xFF
+std::string buildRequest(const std::string& method, const std::string& path, size_t bodyBytes) {
+    std::string body;
+    std::string contentType;
+    if (bodyBytes > 0) {
+        const char* boundary = "----loadtestboundary";
+        contentType = std::string("multipart/form-data; boundary=") + boundary;
+        body = std::string("--") + boundary + "\r\n"
+            "Content-Disposition: form-data; name=\"firmware\"; filename=\"firmware.bin\"\r\n"
+            "Content-Type: application/octet-stream\r\n\r\n";
+        if (firmware.empty()) {
+            body.append(bodyBytes, '\xff');
+        } else {
+            body += firmware;
+        }
+        body += std::string("\r\n--") + boundary + "--\r\n";
+    }
+
+    std::string request = method + " " + path + " HTTP/1.1\r\n"
+        "Host: " + options.host + "\r\n"
+        "Connection: close\r\n";
+    if (!body.empty()) {
+        request += "Content-Type: " + contentType + "\r\n"
+            "Content-Length: " + std::to_string(body.size()) + "\r\n";
+    }
+    return request + "\r\n" + body;
+}
+
+// Funkcja wysyłająca zapytanie i odczytująca odpowiedź aż do zamknięcia połączenia
+// Zwraca kod odpowiedzi HTTP, CONNECT_FAILED gdy nie udało się połączyć lub 0 przy innym błędzie połączenia
+int performRequest(const std::string& request, uint64_t& bytesReceived) {
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) {
+        return 0;
+    }
+    timeval timeout = {options.timeoutMs / 1000, (options.timeoutMs % 1000) * 1000};
+    int one = 1;
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    if (connect(fd, (sockaddr*)&target, sizeof(target)) != 0) {
+        close(fd);
+        return CONNECT_FAILED;
+    }
+
+    const char* data = request.data();
+    size_t size = request.size();
+    while (size > 0) {
+        ssize_t sent = send(fd, data, size, MSG_NOSIGNAL);
+        if (sent <= 0) {
+            close(fd);
+            return 0;
+        }
+        data += sent;
+        size -= sent;
+    }
+
+    char buf[4096];
+    char status[16] = {};
+    size_t statusLength = 0;
+    ssize_t received;
+    while ((received = recv(fd, buf, sizeof(buf), 0)) > 0) {
+        for (ssize_t i = 0; i < received && statusLength < sizeof(status) - 1; i++) {
+            status[statusLength++] = buf[i];
+        }
+        bytesReceived += received;
+    }
+    close(fd);
+
+    int code = 0;
+    if (received < 0 || sscanf(status, "HTTP/%*d.%*d %d", &code) != 1) {
+        return 0;
+    }
+    return code;
+}
+
+// Funkcja zapisująca wynik zapytania do wyników lokalnych wątku
+void record(std::map<std::string, RouteStats>& local, const std::string& route, int code, double latencyMs,
+            uint64_t bytes) {
+    RouteStats& routeStats = local[route];
+    routeStats.requests++;
+    routeStats.bytes += bytes;
+    if (code >= 200 && code < 300) {
+        routeStats.latencies.push_back(latencyMs);
+    } else {
+        routeStats.errors++;
+        if (code == CONNECT_FAILED) {
+            routeStats.connectErrors++;
+        }
+    }
+}
+
+// Funkcja dołączająca wyniki wątku do wyników zbiorczych
+void merge(const std::map<std::string, RouteStats>& local) {
+    std::lock_guard<std::mutex> lock(statsMutex);
+    for (const auto& entry : local) {
+        RouteStats& routeStats = stats[entry.first];
+        routeStats.requests += entry.second.requests;
+        routeStats.errors += entry.second.errors;
+        routeStats.connectErrors += entry.second.connectErrors;
+        routeStats.bytes += entry.second.bytes;
+        routeStats.latencies.insert(routeStats.latencies.end(),
+            entry.second.latencies.begin(), entry.second.latencies.end());
+    }
+}
+
+// Funkcja zwracająca zaplanowany czas i-tego zapytania strumienia w sekundach od startu
+double scheduledTime(const Stream& stream, uint64_t i) {
+    if (stream.burstMs <= 0) {
+        return i / stream.rate;
+    }
+    uint64_t perBurst = std::max<uint64_t>(1, (uint64_t)(stream.rate * stream.burstMs / 1000));
+    return (i / perBurst) * (stream.burstMs + stream.pauseMs) / 1000.0 + (i % perBurst) / stream.rate;
+}
+
+// Funkcja uruchamiająca wątki jednego strumienia
+void runStream(const Stream& stream, Clock::time_point start, Clock::time_point end,
+               std::vector<std::thread>& threads) {
+    auto next = std::make_shared<std::atomic<uint64_t>>(0);
+    auto request = std::make_shared<std::string>();
+    if (stream.path.find("%d") == std::string::npos) {
+        *request = buildRequest(stream.method, stream.path, stream.bodyBytes);
+    }
+    std::string route = routeOf(stream.path);
+
+    for (int c = 0; c < stream.connections; c++) {
+        threads.emplace_back([stream, start, end, next, request, route]() {
+            std::map<std::string, RouteStats> local;
+            while (true) {
+                uint64_t i = next->fetch_add(1);
+                Clock::time_point due;
+                if (stream.rate > 0) {
+                    due = start + std::chrono::duration_cast<Clock::duration>(
+                        std::chrono::duration<double>(scheduledTime(stream, i)));
+                    std::this_thread::sleep_until(due);
+                } else {
+                    std::this_thread::sleep_until(start);
+                    due = Clock::now();
+                }
+                if (due >= end) {
+                    break;
+                }
+
+                std::string dynamic;
+                if (request->empty()) {
+                    // Wartości suwaka przesuwane tam i z powrotem w zakresie 0-255, jak przy przeciąganiu
+                    char path[128];
+                    int value = (int)(i % 510);
+                    snprintf(path, sizeof(path), stream.path.c_str(), value < 256 ? value : 509 - value);
+                    dynamic = buildRequest(stream.method, path, stream.bodyBytes);
+                }
+
+                uint64_t bytes = 0;
+                int code = performRequest(request->empty() ? dynamic : *request, bytes);
+                double latencyMs = std::chrono::duration<double, std::milli>(Clock::now() - due).count();
+                record(local, route, code, latencyMs, bytes);
+                if (code == CONNECT_FAILED && stream.rate == 0) {
+                    // Bez przerwy pętla zamknięta przy niedostępnym serwerze (np. restart urządzenia) zliczałaby
+                    // jedynie szybkość ponawiania prób zamiast rzeczywistego ruchu
+                    std::this_thread::sleep_for(std::chrono::milliseconds(RETRY_DELAY_MS));
+                }
+            }
+            merge(local);
+        });
+    }
+}
+
+// Funkcja uruchamiająca odtwarzanie nagranego ruchu
+void runReplay(const std::vector<ReplayEntry>& entries, Clock::time_point start, Clock::time_point end,
+               std::vector<std::thread>& threads) {
+    auto next = std::make_shared<std::atomic<size_t>>(0);
+    int connections = std::max(1, (int)(6 * options.scale));
+    for (int c = 0; c < connections; c++) {
+        threads.emplace_back([&entries, start, end, next]() {
+            std::map<std::string, RouteStats> local;
+            size_t i;
+            while ((i = next->fetch_add(1)) < entries.size()) {
+                const ReplayEntry& entry = entries[i];
+                auto due = start + std::chrono::duration_cast<Clock::duration>(
+                    std::chrono::duration<double, std::milli>(entry.timeMs / options.scale));
+                if (due >= end) {
+                    break;
+                }
+                std::this_thread::sleep_until(due);
+                uint64_t bytes = 0;
+                int code = performRequest(buildRequest(entry.method, entry.path, entry.bodyBytes), bytes);
+                double latencyMs = std::chrono::duration<double, std::milli>(Clock::now() - due).count();
+                record(local, routeOf(entry.path), code, latencyMs, bytes);
+            }
+            merge(local);
+        });
+    }
+}
+
+// Funkcja wczytująca nagrany ruch
+// Każda linia ma postać "<czas_ms> <METODA> <ścieżka> [rozmiar_pliku]", linie zaczynające się od '#' są pomijane
+// Rozmiar pliku jest dopuszczalny tylko dla POST /upload, bo tylko tam oprogramowanie przyjmuje przesyłany plik
+bool loadReplay(const std::string& file, std::vector<ReplayEntry>& entries) {
+    std::ifstream input(file);
+    if (!input) {
+        return false;
+    }
+    std::string line;
+    while (std::getline(input, line)) {
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        std::istringstream fields(line);
+        ReplayEntry entry = {0, "", "", 0};
+        if (!(fields >> entry.timeMs >> entry.method >> entry.path)) {
+            fprintf(stderr, "Invalid replay line: %s\n", line.c_str());
+            return false;
+        }
+        std::string body;
+        std::string rest;
+        if (fields >> body) {
+            char* parseEnd = nullptr;
+            unsigned long long bytes = strtoull(body.c_str(), &parseEnd, 10);
+            if (!isdigit((unsigned char)body[0]) || *parseEnd != '\0' || bytes > MAX_BODY_BYTES || (fields >> rest)) {
+                fprintf(stderr, "Invalid body size in replay line: %s\n", line.c_str());
+                return false;
+            }
+            if (bytes > 0 && (entry.method != "POST" || routeOf(entry.path) != "/upload")) {
+                fprintf(stderr, "Body size is only supported for POST /upload: %s\n", line.c_str());
+                return false;
+            }
+            entry.bodyBytes = bytes;
+        }
+        entries.push_back(entry);
+    }
+    std::sort(entries.begin(), entries.end(),
+        [](const ReplayEntry& a, const ReplayEntry& b) { return a.timeMs < b.timeMs; });
+    return true;
+}
+
+// Funkcja zwracająca strumienie wbudowanego profilu ruchu
+// Przeglądarka otwiera do 6 połączeń naraz, a zdarzenie oninput suwaka wywołuje updateBrightness() około 60 razy na sekundę
+bool buildProfile(const std::string& name, std::vector<Stream>& streams) {
+    double s = options.scale;
+    int browsers = std::max(1, (int)(4 * s));
+    Stream slider = {"GET", "/setBrightness?value=%d", 0, 6 * browsers, 60.0 * browsers, 1000, 500};
+    Stream sliderOne = {"GET", "/setBrightness?value=%d", 0, 6, 60.0 * s, 1000, 500};
+    Stream root = {"GET", "/", 0, std::max(1, (int)(8 * s)), 0, 0, 0};
+    Stream rootPoll = {"GET", "/", 0, 2, 0.5 * s, 0, 0};
+    Stream toggle = {"GET", "/toggleLED", 0, 2, 1.0 * s, 0, 0};
+    Stream networks = {"GET", "/networks", 0, 1, 0, 0, 0};
+    Stream upload = {"POST", "/upload", 1024 * 1024, 1, 0, 0, 0};
+
+    if (name == "slider") {
+        streams = {slider};
+    } else if (name == "root") {
+        streams = {root};
+    } else if (name == "networks") {
+        streams = {networks, sliderOne, toggle};
+    } else if (name == "ota") {
+        streams = {upload, sliderOne, rootPoll};
+    } else if (name == "mixed") {
+        streams = {sliderOne, rootPoll, toggle, networks, upload};
+    } else {
+        return false;
+    }
+    return true;
+}
+
+// Funkcja zwracająca percentyl posortowanych opóźnień (metoda najbliższej pozycji)
+double percentile(const std::vector<double>& sorted, double p) {
+    if (sorted.empty()) {
+        return 0;
+    }
+    size_t rank = (size_t)(p / 100.0 * sorted.size() + 0.999999);
+    return sorted[std::min(sorted.size(), std::max<size_t>(rank, 1)) - 1];
+}
+
+// Funkcja zwracająca tekst w postaci napisu JSON
+std::string jsonString(const std::string& text) {
+    std::string result = "\"";
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            result += '\\';
+            result += c;
+        } else if ((unsigned char)c < 0x20) {
+            char escape[8];
+            snprintf(escape, sizeof(escape), "\\u%04x", c);
+            result += escape;
+        } else {
+            result += c;
+        }
+    }
+    return result + "\"";
+}
+
+// Funkcja zwracająca liczbę z trzema miejscami po przecinku
+std::string jsonNumber(double value) {
+    char text[64];
+    snprintf(text, sizeof(text), "%.3f", value);
+    return text;
+}
+
+// Funkcja wypisująca wyniki i zapisująca podsumowanie JSON
+// Przepustowość liczona jest względem okna wysyłania (--duration), a czas oczekiwania na zakończenie zapytań
+// rozpoczętych w tym oknie jest podawany osobno jako drain_s
+bool report(double window, double drain) {
+    printf("%-16s %9s %7s %8s %10s %10s %10s %10s\n",
+        "route", "requests", "errors", "err%", "req/s", "p50 ms", "p99 ms", "p999 ms");
+
+    std::string json = "{\n  \"target\": " + jsonString(options.host + ":" + std::to_string(options.port)) + ",\n"
+        "  \"profile\": " + jsonString(options.replayFile.empty() ? options.profile : "replay") + ",\n"
+        "  \"firmware\": " + (options.firmwareFile.empty() ? "null" : jsonString(options.firmwareFile)) + ",\n"
+        "  \"scale\": " + jsonNumber(options.scale) + ",\n"
+        "  \"duration_s\": " + jsonNumber(window) + ",\n"
+        "  \"drain_s\": " + jsonNumber(drain) + ",\n"
+        "  \"routes\": {";
+
+    bool first = true;
+    for (auto& entry : stats) {
+        RouteStats& routeStats = entry.second;
+        std::sort(routeStats.latencies.begin(), routeStats.latencies.end());
+        double errorRate = routeStats.requests ? (double)routeStats.errors / routeStats.requests : 0;
+        double throughput = window > 0 ? routeStats.latencies.size() / window : 0;
+        double p50 = percentile(routeStats.latencies, 50);
+        double p99 = percentile(routeStats.latencies, 99);
+        double p999 = percentile(routeStats.latencies, 99.9);
+        double max = routeStats.latencies.empty() ? 0 : routeStats.latencies.back();
+
+        printf("%-16s %9llu %7llu %7.2f%% %10.2f %10.1f %10.1f %10.1f\n", entry.first.c_str(),
+            (unsigned long long)routeStats.requests, (unsigned long long)routeStats.errors,
+            errorRate * 100, throughput, p50, p99, p999);
+
+        char rate[32];
+        snprintf(rate, sizeof(rate), "%.6f", errorRate);
+        json += std::string(first ? "" : ",") + "\n    " + jsonString(entry.first) + ": {"
+            "\"requests\": " + std::to_string(routeStats.requests) + ", "
+            "\"errors\": " + std::to_string(routeStats.errors) + ", "
+            "\"connect_errors\": " + std::to_string(routeStats.connectErrors) + ", "
+            "\"error_rate\": " + rate + ", "
+            "\"throughput_rps\": " + jsonNumber(throughput) + ", "
+            "\"p50_ms\": " + jsonNumber(p50) + ", "
+            "\"p99_ms\": " + jsonNumber(p99) + ", "
+            "\"p999_ms\": " + jsonNumber(p999) + ", "
+            "\"max_ms\": " + jsonNumber(max) + ", "
+            "\"bytes\": " + std::to_string(routeStats.bytes) + "}";
+        first = false;
+    }
+    json += "\n  }\n}\n";
+    printf("window %.1f s, drain %.1f s\n", window, drain);
+
+    if (!options.jsonFile.empty()) {
+        std::ofstream output(options.jsonFile);
+        output << json;
+        if (!output) {
+            fprintf(stderr, "Unable to write %s\n", options.jsonFile.c_str());
+            return false;
+        }
+    }
+    return true;
+}
+
+void usage(const char* name) {
+    fprintf(stderr,
+        "Usage: %s [--host ADDR] [--port N] [--profile slider|root|networks|ota|mixed] [--replay FILE]\n"
+        "          [--duration S] [--scale X] [--timeout-ms N] [--json FILE] [--firmware FILE]\n", name);
+}
+
+int main(int argc, char** argv) {
+    for (int i = 1; i < argc; i++) {
+        if (i + 1 >= argc) {
+            usage(argv[0]);
+            return 2;
+        }
+        std::string arg = argv[i];
+        const char* next = argv[++i];
+        if (arg == "--host") {
+            options.host = next;
+        } else if (arg == "--port") {
+            options.port = atoi(next);
+        } else if (arg == "--profile") {
+            options.profile = next;
+        } else if (arg == "--replay") {
+            options.replayFile = next;
+        } else if (arg == "--duration") {
+            options.duration = atof(next);
+        } else if (arg == "--scale") {
+            options.scale = atof(next) > 0 ? atof(next) : 1;
+        } else if (arg == "--timeout-ms") {
+            options.timeoutMs = atoi(next);
+        } else if (arg == "--json") {
+            options.jsonFile = next;
+        } else if (arg == "--firmware") {
+            options.firmwareFile = next;
+        } else {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+
+    addrinfo hints = {};
+    addrinfo* result = nullptr;
+    hints.ai_family = AF_INET;
+    hints.ai_socktype = SOCK_STREAM;
+    if (getaddrinfo(options.host.c_str(), std::to_string(options.port).c_str(), &hints, &result) != 0) {
+        fprintf(stderr, "Unable to resolve %s\n", options.host.c_str());
+        return 1;
+    }
+    target = *(sockaddr_in*)result->ai_addr;
+    freeaddrinfo(result);
+
+    if (!options.firmwareFile.empty()) {
+        std::ifstream input(options.firmwareFile, std::ios::binary);
+        std::ostringstream content;
+        content << input.rdbuf();
+        firmware = content.str();
+        if (!input || firmware.empty()) {
+            fprintf(stderr, "Unable to load %s\n", options.firmwareFile.c_str());
+            return 1;
+        }
+    }
+
+    std::vector<Stream> streams;
+    std::vector<ReplayEntry> entries;
+    if (!options.replayFile.empty()) {
+        if (!loadReplay(options.replayFile, entries)) {
+            fprintf(stderr, "Unable to load %s\n", options.replayFile.c_str());
+            return 1;
+        }
+    } else if (!buildProfile(options.profile, streams)) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    Clock::time_point start = Clock::now() + std::chrono::milliseconds(100);
+    Clock::time_point end = start + std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<double>(options.duration));
+    std::vector<std::thread> threads;
+    for (const Stream& stream : streams) {
+        runStream(stream, start, end, threads);
+    }
+    if (!entries.empty()) {
+        runReplay(entries, start, end, threads);
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    double drain = std::chrono::duration<double>(Clock::now() - end).count();
+    return report(options.duration, drain > 0 ? drain : 0) ? 0 : 1;
+}
@@ -0,0 +1,213 @@
+
+// Zastępczy serwer HTTP odwzorowujący ścieżki obsługiwane przez main.cpp, uruchamiany na Linuksie
+// Podobnie jak WebServer z ESP32 obsługuje jednego klienta naraz w jednym wątku i zamyka połączenie po odpowiedzi,
+// a blokujące operacje (skanowanie sieci, zapis do flash) są symulowane opóźnieniami
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+
+
+// Ustawienia symulacji
+struct Options {
+    int port = 8080;                // Port serwera HTTP
+    int backlog = 5;                // Długość kolejki połączeń (lwIP na ESP32 ma ich niewiele)
+    int scanMs = 2500;              // Czas trwania WiFi.scanNetworks() w milisekundach
+    int flashKBps = 300;            // Szybkość zapisu aktualizacji do flash w KB/s
+    size_t rootBytes = 9000;        // Rozmiar strony głównej w bajtach
+    int recvTimeoutMs = 5000;       // Czas oczekiwania na dane od klienta
+};
+
+Options options;                    // Zmienna przechowująca ustawienia symulacji
+bool ledEnabled = true;             // Stan diody LED
+int ledBrightness = 128;            // Jasność diody LED
+
+
+// Funkcja wysyłająca cały bufor do klienta
+bool sendAll(int fd, const char* data, size_t size) {
+    while (size > 0) {
+        ssize_t sent = send(fd, data, size, MSG_NOSIGNAL);
+        if (sent <= 0) {
+            return false;
+        }
+        data += sent;
+        size -= sent;
+    }
+    return true;
+}
+
+// Funkcja wysyłająca odpowiedź HTTP i zamykająca połączenie, tak jak WebServer::send()
+void sendResponse(int fd, int code, const char* contentType, const std::string& body) {
+    char head[256];
+    int length = snprintf(head, sizeof(head),
+        "HTTP/1.1 %d %s\r\n"
+        "Content-Type: %s\r\n"
+        "Content-Length: %zu\r\n"
+        "Connection: close\r\n\r\n",
+        code, code == 200 ? "OK" : code == 400 ? "Bad Request" : code == 404 ? "Not Found" : "Error",
+        contentType, body.size());
+    if (sendAll(fd, head, length)) {
+        sendAll(fd, body.data(), body.size());
+    }
+}
+
+// Funkcja zwracająca wartość parametru z części zapytania ścieżki
+bool queryArg(const std::string& query, const char* name, std::string& value) {
+    size_t nameLength = strlen(name);
+    size_t pos = 0;
+    while (pos < query.size()) {
+        size_t end = query.find('&', pos);
+        if (end == std::string::npos) {
+            end = query.size();
+        }
+        if (query.compare(pos, nameLength, name) == 0 && pos + nameLength < end && query[pos + nameLength] == '=') {
+            value = query.substr(pos + nameLength + 1, end - pos - nameLength - 1);
+            return true;
+        }
+        pos = end + 1;
+    }
+    return false;
+}
+
+// Funkcja obsługująca pojedyncze połączenie
+void handleClient(int fd) {
+    // Odczytanie nagłówków zapytania
+    std::string request;
+    char buf[4096];
+    size_t headerEnd;
+    while ((headerEnd = request.find("\r\n\r\n")) == std::string::npos) {
+        ssize_t received = recv(fd, buf, sizeof(buf), 0);
+        if (received <= 0 || request.size() > 16384) {
+            return;
+        }
+        request.append(buf, received);
+    }
+
+    std::string method = request.substr(0, request.find(' '));
+    size_t uriStart = method.size() + 1;
+    std::string uri = request.substr(uriStart, request.find(' ', uriStart) - uriStart);
+    std::string path = uri.substr(0, uri.find('?'));
+    std::string query = uri.find('?') == std::string::npos ? "" : uri.substr(uri.find('?') + 1);
+
+    size_t contentLength = 0;
+    size_t lengthPos = request.find("Content-Length:");
+    if (lengthPos != std::string::npos && lengthPos < headerEnd) {
+        contentLength = strtoul(request.c_str() + lengthPos + 15, nullptr, 10);
+    }
+
+    // Odczytanie treści zapytania, przy /upload z symulacją czasu zapisu do flash
+    size_t bodyReceived = request.size() - headerEnd - 4;
+    auto flashStart = std::chrono::steady_clock::now();
+    auto flashDue = [&]() {     // Czas zakończenia zapisu do flash wszystkich dotychczas odebranych bajtów
+        return flashStart + std::chrono::microseconds(bodyReceived * 1000000 / (options.flashKBps * 1024));
+    };
+    while (bodyReceived < contentLength) {
+        ssize_t received = recv(fd, buf, sizeof(buf), 0);
+        if (received <= 0) {
+            return;
+        }
+        bodyReceived += received;
+        if (path == "/upload") {
+            std::this_thread::sleep_until(flashDue());
+        }
+    }
+
+    if (path == "/upload") {
+        // Czas zapisu liczony od całej treści, również tej odebranej razem z nagłówkami
+        std::this_thread::sleep_until(flashDue());
+    }
+
+    std::string value;
+    if (path == "/") {
+        sendResponse(fd, 200, "text/html", std::string(options.rootBytes, 'x'));
+    } else if (path == "/setBrightness") {
+        if (queryArg(query, "value", value)) {
+            ledBrightness = atoi(value.c_str()) & 0xFF;
+            sendResponse(fd, 200, "text/plain", "OK");
+        } else {
+            sendResponse(fd, 400, "text/plain", "Missing value");
+        }
+    } else if (path == "/toggleLED") {
+        ledEnabled = !ledEnabled;
+        sendResponse(fd, 200, "text/plain", "OK");
+    } else if (path == "/networks") {
+        std::this_thread::sleep_for(std::chrono::milliseconds(options.scanMs));
+        sendResponse(fd, 200, "text/html", std::string(3000, 'x'));
+    } else if (path == "/upload" && method == "POST") {
+        // Prawdziwe urządzenie restartuje się po udanej aktualizacji, tutaj serwer działa dalej
+        sendResponse(fd, 200, "text/html", std::string(2500, 'x'));
+    } else if (path == "/api/trace") {
+        sendResponse(fd, 200, "application/octet-stream", std::string(16 + 256 * 12, '\0'));
+    } else if ((path == "/save" || path == "/save_network") && method == "POST") {
+        // Zapis ustawień kończy się restartem urządzenia, którego serwer zastępczy nie symuluje
+        sendResponse(fd, 200, "text/html", std::string(2500, 'x'));
+    } else {
+        sendResponse(fd, 404, "text/plain", "Not found: " + path);
+    }
+}
+
+void usage(const char* name) {
+    fprintf(stderr,
+        "Usage: %s [--port N] [--backlog N] [--scan-ms N] [--flash-kbps N] [--root-bytes N]\n", name);
+}
+
+int main(int argc, char** argv) {
+    for (int i = 1; i < argc; i++) {
+        if (i + 1 >= argc) {
+            usage(argv[0]);
+            return 2;
+        }
+        std::string arg = argv[i];
+        const char* next = argv[++i];
+        if (arg == "--port") {
+            options.port = atoi(next);
+        } else if (arg == "--backlog") {
+            options.backlog = atoi(next);
+        } else if (arg == "--scan-ms") {
+            options.scanMs = atoi(next);
+        } else if (arg == "--flash-kbps") {
+            options.flashKBps = atoi(next) > 0 ? atoi(next) : 1;
+        } else if (arg == "--root-bytes") {
+            options.rootBytes = strtoul(next, nullptr, 10);
+        } else {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+
+    int server = socket(AF_INET, SOCK_STREAM, 0);
+    int one = 1;
+    setsockopt(server, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_ANY);
+    address.sin_port = htons(options.port);
+    if (bind(server, (sockaddr*)&address, sizeof(address)) != 0 || listen(server, options.backlog) != 0) {
+        perror("bind/listen");
+        return 1;
+    }
+    fprintf(stderr, "Stand-in listening on port %d\n", options.port);
+
+    // Główna pętla, odpowiednik wywołań server.handleClient() w loop()
+    timeval timeout = {options.recvTimeoutMs / 1000, (options.recvTimeoutMs % 1000) * 1000};
+    while (true) {
+        int client = accept(server, nullptr, nullptr);
+        if (client < 0) {
+            continue;
+        }
+        setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+        setsockopt(client, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+        handleClient(client);
+        close(client);
+    }
+}